@@ -1,6 +1,8 @@
 #include <algorithm>
+#include <gtest/gtest-typed-test.h>
 #include <gtest/gtest.h>
 #include <map.hpp>
+#include <limits>
 #include <list>
 #include <map>
 #include <time.h>
@@ -57,6 +59,53 @@ namespace {
 		EXPECT_TRUE(m0 == m1);
 	}
 
+	TEST(MapBasicTest, CopyIsIndependent)
+	{
+		ft::map< int, int > m0;
+
+		for (int i = 0; i < 100; ++i)
+			m0.insert(ft::make_pair(i, i));
+
+		ft::map< int, int > m1(m0);
+
+		// Writes on either side must never leak into the other copy
+		for (int i = 0; i < 100; i += 2)
+			m0.erase(i);
+		for (int i = 100; i < 150; ++i)
+			m0.insert(ft::make_pair(i, i));
+		m0[1] = 42;
+		m1[3] = 43;
+
+		EXPECT_EQ(m0.size(), size_t(100));
+		EXPECT_EQ(m1.size(), size_t(100));
+		for (int i = 0; i < 100; ++i)
+			EXPECT_EQ(m1.count(i), size_t(1));
+		EXPECT_EQ(m1.count(100), size_t(0));
+		EXPECT_EQ(m1[1], 1);
+		EXPECT_EQ(m0[3], 3);
+		EXPECT_EQ(m0[1], 42);
+		EXPECT_EQ(m1[3], 43);
+	}
+
+	TEST(MapBasicTest, LargeCopyClearAndDestruction)
+	{
+		ft::map< int, int > *m0 = new ft::map< int, int >;
+
+		for (int i = 0; i < 100000; ++i)
+			m0->insert(ft::make_pair(i, i));
+
+		ft::map< int, int > m1(*m0);
+		delete m0;
+		EXPECT_EQ(m1.size(), size_t(100000));
+		EXPECT_EQ((--m1.end())->first, 99999);
+
+		m1.clear();
+		EXPECT_TRUE(m1.empty());
+		EXPECT_TRUE(m1.begin() == m1.end());
+		m1.insert(ft::make_pair(1, 1));
+		EXPECT_EQ(m1.size(), size_t(1));
+	}
+
 //	TEST(MapBasicTest, DISABLED_SegfaultTest)
 //	{
 //		ft::map< std::string, int > myMap;
@@ -249,6 +298,160 @@ namespace {
 		EXPECT_TRUE(comp_pair(*myIt2, *stdIt2));
 	}
 
+	TEST(MapBasicTest, OperatorBracketCounter)
+	{
+		ft::map< int, int > myMap;
+		std::map< int, int > stdMap;
+
+		// Mix of misses (insert a zero) and hits (update in place)
+		for (int i = 0; i < 1000; ++i)
+		{
+			myMap[(i * 7) % 31] += 1;
+			stdMap[(i * 7) % 31] += 1;
+		}
+		EXPECT_EQ(myMap.size(), stdMap.size());
+		for (int i = 0; i < 31; ++i)
+			EXPECT_EQ(myMap[i], stdMap[i]);
+
+		int &ref = myMap[5];
+		ref = 42;
+		EXPECT_EQ(myMap.find(5)->second, 42);
+		EXPECT_TRUE(&myMap[5] == &ref);
+	}
+
+	// Counts how many mapped values get built
+	struct CountedValue {
+		static int built;
+		int v;
+
+		CountedValue() : v(0) { ++built; }
+		CountedValue(const CountedValue &other) : v(other.v) { ++built; }
+		CountedValue &operator=(const CountedValue &other) { v = other.v; return *this; }
+	};
+
+	int CountedValue::built = 0;
+
+	// operator[] must not build a default mapped_type when the key is
+	// already there; enable once map.hpp does a single descent
+	TEST(MapBasicTest, DISABLED_OperatorBracketHitBuildsNothing)
+	{
+		ft::map< int, CountedValue > myMap;
+
+		for (int i = 0; i < 10; ++i)
+			myMap[i].v = i;
+		CountedValue::built = 0;
+		for (int i = 0; i < 10; ++i)
+			EXPECT_EQ(myMap[i].v, i);
+		EXPECT_EQ(CountedValue::built, 0);
+	}
+
+	TEST(MapBasicTest, StringKeyLookups)
+	{
+		ft::map< std::string, int > myMap;
+		std::map< std::string, int > stdMap;
+		const char *keys[] = { "/", "/api", "/api/v1/users", "/api/v1/users/settings", "/static" };
+
+		for (int i = 0; i < 5; ++i)
+		{
+			myMap.insert(ft::make_pair(std::string(keys[i]), i));
+			stdMap.insert(std::make_pair(std::string(keys[i]), i));
+		}
+
+		// Lookups are written with literals, as callers do
+		EXPECT_EQ(myMap.count("/api"), stdMap.count("/api"));
+		EXPECT_EQ(myMap.count("/apis"), stdMap.count("/apis"));
+		EXPECT_EQ(myMap.find("/static")->second, stdMap.find("/static")->second);
+		EXPECT_TRUE(myMap.find("/nope") == myMap.end());
+		EXPECT_EQ(myMap.at("/api/v1/users"), stdMap.at("/api/v1/users"));
+		EXPECT_THROW(myMap.at("/api/v2"), std::out_of_range);
+		EXPECT_TRUE(comp_pair(*myMap.lower_bound("/api/v1"), *stdMap.lower_bound("/api/v1")));
+		EXPECT_TRUE(comp_pair(*myMap.upper_bound("/api/v1/users"), *stdMap.upper_bound("/api/v1/users")));
+		EXPECT_TRUE(myMap.equal_range("/api").first == myMap.find("/api"));
+		EXPECT_TRUE(myMap.equal_range("/api").second == myMap.upper_bound("/api"));
+		EXPECT_EQ(myMap["/api"], stdMap["/api"]);
+		EXPECT_EQ(myMap.size(), stdMap.size());
+	}
+
+	TEST(MapBasicTest, StringKeyOrdering)
+	{
+		ft::map< std::string, int > myMap;
+		std::map< std::string, int > stdMap;
+		std::string long_prefix(40, 'a');
+		std::string keys[] = {
+			"", "a", "aaaaaaa", "aaaaaaaa", "aaaaaaaaa", "aaaaaaab", "aaaaaaaab",
+			long_prefix, long_prefix + "a", long_prefix + "b", long_prefix.substr(0, 39) + "b",
+			std::string("ab\0c", 4), std::string("ab\0d", 4), std::string("ab", 2),
+			"\x7f", "\x80", "\xff", "a\xff", "a\x01"
+		};
+		const int nkeys = sizeof(keys) / sizeof(keys[0]);
+
+		// Keys equal on their first 8 bytes, prefixes of one another,
+		// embedded NULs and bytes above 0x7f must all order as std::string
+		for (int i = 0; i < nkeys; ++i)
+		{
+			myMap.insert(ft::make_pair(keys[i], i));
+			stdMap.insert(std::make_pair(keys[i], i));
+		}
+		EXPECT_EQ(myMap.size(), stdMap.size());
+
+		ft::map< std::string, int >::iterator it = myMap.begin();
+		std::map< std::string, int >::iterator sit = stdMap.begin();
+		for (; sit != stdMap.end(); ++it, ++sit)
+			EXPECT_TRUE(comp_pair(*it, *sit));
+		for (int i = 0; i < nkeys; ++i)
+		{
+			EXPECT_EQ(myMap.find(keys[i])->second, i);
+			EXPECT_TRUE(comp_pair(*myMap.upper_bound(keys[i].substr(0, keys[i].size() / 2)),
+				*stdMap.upper_bound(keys[i].substr(0, keys[i].size() / 2))));
+		}
+	}
+
+	TEST(MapBasicTest, ArithmeticKeys)
+	{
+		ft::map< long, int > myLong;
+		std::map< long, int > stdLong;
+		ft::map< double, int > myDouble;
+		std::map< double, int > stdDouble;
+		ft::map< int, int, std::greater< int > > myGreater;
+		std::map< int, int, std::greater< int > > stdGreater;
+		const long extremes[] = { std::numeric_limits< long >::min(), -1, 0, 1,
+			std::numeric_limits< long >::max() };
+
+		// Extremes and negatives for std::less keys, and a comparator
+		// that is not std::less on the same kind of key
+		for (int i = 0; i < 5; ++i)
+		{
+			myLong.insert(ft::make_pair(extremes[i], i));
+			stdLong.insert(std::make_pair(extremes[i], i));
+		}
+		for (int i = -50; i < 50; ++i)
+		{
+			myDouble.insert(ft::make_pair(i * 0.5, i));
+			stdDouble.insert(std::make_pair(i * 0.5, i));
+			myGreater.insert(ft::make_pair(i, i));
+			stdGreater.insert(std::make_pair(i, i));
+		}
+
+		for (int i = 0; i < 5; ++i)
+		{
+			EXPECT_EQ(myLong.find(extremes[i])->second, i);
+			EXPECT_TRUE(comp_pair(*myLong.lower_bound(extremes[i]), *stdLong.lower_bound(extremes[i])));
+		}
+		EXPECT_TRUE(comp_pair(*myLong.begin(), *stdLong.begin()));
+		EXPECT_TRUE(comp_pair(*myLong.rbegin(), *stdLong.rbegin()));
+		for (int i = -60; i < 49; ++i)
+		{
+			EXPECT_EQ(myDouble.count(i * 0.25), stdDouble.count(i * 0.25));
+			EXPECT_TRUE(comp_pair(*myDouble.upper_bound(i * 0.25), *stdDouble.upper_bound(i * 0.25)));
+			EXPECT_EQ(myGreater.count(i), stdGreater.count(i));
+			if (i > -50)
+			{
+				EXPECT_TRUE(comp_pair(*myGreater.upper_bound(i), *stdGreater.upper_bound(i)));
+			}
+		}
+		EXPECT_TRUE(comp_pair(*myGreater.begin(), *stdGreater.begin()));
+	}
+
 	// Example module 97 key compare function
 	struct ModCmp {
 		bool operator()(const int lhs, const int rhs) const
@@ -289,6 +492,76 @@ namespace {
 		EXPECT_FALSE(comp_val(*it, val));
 	}
 
+	// Same ordering as ModCmp, counting every call
+	struct CountingModCmp {
+		static size_t calls;
+
+		bool operator()(const int lhs, const int rhs) const
+		{
+			++calls;
+			return (lhs % 97) < (rhs % 97);
+		}
+	};
+
+	size_t CountingModCmp::calls = 0;
+
+	// A red-black tree of n nodes is at most 2 * log2(n + 1) high
+	size_t rbMaxHeight(size_t n)
+	{
+		size_t log = 0;
+
+		for (++n; n > 1; n >>= 1)
+			++log;
+		return (2 * (log + 1));
+	}
+
+	TEST(MapBasicTest, EquivalentKeysLookup)
+	{
+		ft::map< int, char, CountingModCmp > myMap;
+		std::map< int, char, CountingModCmp > stdMap;
+
+		for (int i = 0; i < 97; i += 3)
+		{
+			myMap.insert(ft::make_pair(i, 'a'));
+			stdMap.insert(std::make_pair(i, 'a'));
+		}
+
+		// 97 + i is equivalent to i, so it must find the stored key
+		for (int i = 0; i < 97; ++i)
+		{
+			EXPECT_EQ(myMap.count(97 + i), stdMap.count(97 + i));
+			if (stdMap.count(97 + i))
+			{
+				EXPECT_EQ(myMap.find(97 + i)->first, i);
+			}
+			EXPECT_TRUE(myMap.equal_range(97 + i).first == myMap.lower_bound(i));
+			EXPECT_TRUE(myMap.equal_range(97 + i).second == myMap.upper_bound(i));
+		}
+		EXPECT_FALSE(myMap.insert(ft::make_pair(97, 'b')).second);
+		EXPECT_EQ(myMap[97], 'a');
+	}
+
+	// A single descent compares once per level plus a final equality
+	// check; enable once map.hpp has the single-descent find/equal_range
+	TEST(MapBasicTest, DISABLED_SingleDescentComparisonCount)
+	{
+		ft::map< int, char, CountingModCmp > myMap;
+
+		for (int i = 0; i < 97; i += 3)
+			myMap.insert(ft::make_pair(i, 'a'));
+
+		const size_t maxHeight = rbMaxHeight(myMap.size());
+		for (int i = 0; i < 97; ++i)
+		{
+			CountingModCmp::calls = 0;
+			myMap.find(i);
+			EXPECT_LE(CountingModCmp::calls, maxHeight + 1);
+			CountingModCmp::calls = 0;
+			myMap.equal_range(i);
+			EXPECT_LE(CountingModCmp::calls, maxHeight + 2);
+		}
+	}
+
 	TEST(PairTest, CanCreateDefaultPair) {
 		ft::pair<int, double> p;
 		EXPECT_EQ(0, p.first);
@@ -380,6 +653,81 @@ namespace {
 		EXPECT_TRUE(m1 == m0);
 	}
 
+	TEST(MapBasicTest, AssignOverNonEmpty)
+	{
+		ft::map< int, std::string > small;
+		ft::map< int, std::string > big;
+
+		for (int i = 0; i < 5; ++i)
+			small.insert(ft::make_pair(i * 10, "small"));
+		for (int i = 0; i < 50; ++i)
+			big.insert(ft::make_pair(i, "big"));
+
+		// Shrinking and growing destinations, with overlapping keys
+		ft::map< int, std::string > dst(big);
+		dst = small;
+		EXPECT_TRUE(dst == small);
+		EXPECT_EQ(dst[10], "small");
+		dst = big;
+		EXPECT_TRUE(dst == big);
+		EXPECT_EQ(dst[10], "big");
+		// Self-assignment through an alias, so compilers don't flag it
+		ft::map< int, std::string > &alias = dst;
+		dst = alias;
+		EXPECT_TRUE(dst == big);
+
+		// clear then refill, as a scratch map is reused
+		for (int round = 0; round < 3; ++round)
+		{
+			dst.clear();
+			EXPECT_TRUE(dst.empty());
+			EXPECT_TRUE(dst.begin() == dst.end());
+			for (int i = 0; i < 20; ++i)
+				dst[i] = "refill";
+			EXPECT_EQ(dst.size(), size_t(20));
+			EXPECT_EQ(dst.begin()->first, 0);
+			EXPECT_EQ((--dst.end())->first, 19);
+		}
+		EXPECT_EQ(big.size(), size_t(50));
+		EXPECT_EQ(small.size(), size_t(5));
+	}
+
+	// Mapped value much larger than the node's links and key
+	struct BigValue {
+		char	payload[200];
+		int		id;
+
+		BigValue() : id(0) { payload[0] = 0; payload[199] = 0; }
+	};
+
+	TEST(MapBasicTest, LargeMappedValue)
+	{
+		ft::map< int, BigValue > myMap;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			myMap[i].id = i;
+			myMap[i].payload[199] = static_cast< char >(i);
+		}
+
+		// Writes through iterators and references must land in the map
+		ft::map< int, BigValue >::iterator it = myMap.begin();
+		for (int i = 0; it != myMap.end(); ++it, ++i)
+		{
+			EXPECT_EQ(it->first, i);
+			EXPECT_EQ((*it).second.id, i);
+			it->second.id += 1000;
+		}
+		BigValue &ref = myMap.find(42)->second;
+		ref.payload[0] = 'x';
+		myMap.erase(41);
+		myMap.erase(43);
+		EXPECT_EQ(myMap.at(42).payload[0], 'x');
+		EXPECT_EQ(myMap.at(42).payload[199], 42);
+		EXPECT_EQ(myMap.at(42).id, 1042);
+		EXPECT_EQ(&myMap[42], &ref);
+	}
+
 	TEST(MapBasicTest, LowerBoundMethod)
 	{
 		ft::map< int, int > myMap;
@@ -431,4 +779,205 @@ namespace {
 		EXPECT_TRUE((myMap.equal_range(7).first == myMap.lower_bound(7)) == (stdMap.equal_range(7).first == stdMap.lower_bound(7)));
 		EXPECT_TRUE((myMap.equal_range(7).second == myMap.upper_bound(7)) == (stdMap.equal_range(7).second == stdMap.upper_bound(7)));
 	}
+
+//////////////////MAP TYPES TESTS////////////////////////////
+	const static int lenm = 64;
+
+	template <typename Map>
+	class MapTest : public testing::Test
+	{
+		protected:
+			MapTest()
+			{
+				return ;
+			}
+
+			void SetUp()
+			{
+				// Keys are spread out so that bounds have gaps to probe
+				for (int i = 0; i < lenm; ++i)
+				{
+					m_.insert(ft::make_pair(i * 3, i));
+					witness_.insert(std::make_pair(i * 3, i));
+				}
+			}
+
+			void TearDown()
+			{
+			}
+
+			// Walks m alongside witness_ and checks they hold the same pairs
+			void expectMatchesWitness(const Map &m)
+			{
+				typename Map::const_iterator			it = m.begin();
+				std::map< int, int >::const_iterator	sit = witness_.begin();
+
+				for (; sit != witness_.end(); ++it, ++sit)
+					EXPECT_TRUE(comp_pair(*it, *sit));
+				EXPECT_TRUE(it == m.end());
+			}
+
+			// Every ordered map implementation listed in MapTypes must
+			// behave exactly like std::map on these cases
+			Map						m_;
+			std::map< int, int >	witness_;
+	};
+
+	typedef testing::Types< ft::map< int, int > > MapTypes;
+	TYPED_TEST_CASE(MapTest, MapTypes);
+
+	TYPED_TEST(MapTest, InsertAndFind)
+	{
+		EXPECT_EQ(this->m_.size(), this->witness_.size());
+		EXPECT_FALSE(this->m_.insert(ft::make_pair(3, 42)).second);
+		EXPECT_EQ(this->m_[3], 1);
+		for (int i = -1; i < lenm * 3 + 1; ++i)
+		{
+			EXPECT_EQ(this->m_.count(i), this->witness_.count(i));
+			if (this->witness_.count(i))
+				EXPECT_EQ(this->m_.find(i)->second, this->witness_.find(i)->second);
+			else
+				EXPECT_TRUE(this->m_.find(i) == this->m_.end());
+		}
+	}
+
+	TYPED_TEST(MapTest, Bounds)
+	{
+		for (int i = -1; i < lenm * 3 - 3; ++i)
+		{
+			EXPECT_TRUE(comp_pair(*this->m_.lower_bound(i), *this->witness_.lower_bound(i)));
+			EXPECT_TRUE(comp_pair(*this->m_.upper_bound(i), *this->witness_.upper_bound(i)));
+		}
+		EXPECT_TRUE(this->m_.lower_bound(lenm * 3) == this->m_.end());
+		EXPECT_TRUE(this->m_.upper_bound(lenm * 3 - 3) == this->m_.end());
+	}
+
+	TYPED_TEST(MapTest, Iteration)
+	{
+		this->expectMatchesWitness(this->m_);
+
+		typename TypeParam::reverse_iterator	rit = this->m_.rbegin();
+		std::map< int, int >::reverse_iterator	srit = this->witness_.rbegin();
+
+		for (; srit != this->witness_.rend(); ++rit, ++srit)
+			EXPECT_TRUE(comp_pair(*rit, *srit));
+		EXPECT_TRUE(rit == this->m_.rend());
+	}
+
+	TYPED_TEST(MapTest, Erase)
+	{
+		for (int i = 0; i < lenm * 3; i += 2)
+			EXPECT_EQ(this->m_.erase(i), this->witness_.erase(i));
+		EXPECT_EQ(this->m_.size(), this->witness_.size());
+
+		this->expectMatchesWitness(this->m_);
+	}
+
+	TYPED_TEST(MapTest, InsertRange)
+	{
+		TypeParam				other;
+		std::map< int, int >	witnessOther;
+
+		// The shared keys are the multiples of 6, where the fixture's values must win
+		for (int i = 0; i < lenm * 3; i += 2)
+		{
+			other.insert(ft::make_pair(i, -i));
+			witnessOther.insert(std::make_pair(i, -i));
+		}
+		this->m_.insert(other.begin(), other.end());
+		this->witness_.insert(witnessOther.begin(), witnessOther.end());
+		EXPECT_EQ(this->m_.size(), this->witness_.size());
+
+		TypeParam	fromRange(this->m_.begin(), this->m_.end());
+		EXPECT_TRUE(fromRange == this->m_);
+
+		this->expectMatchesWitness(fromRange);
+	}
+
+	TYPED_TEST(MapTest, EraseRange)
+	{
+		// Oldest keys first, then a slice in the middle, then the tail
+		this->m_.erase(this->m_.begin(), this->m_.lower_bound(lenm * 3 / 10));
+		this->witness_.erase(this->witness_.begin(), this->witness_.lower_bound(lenm * 3 / 10));
+		this->m_.erase(this->m_.lower_bound(60), this->m_.upper_bound(90));
+		this->witness_.erase(this->witness_.lower_bound(60), this->witness_.upper_bound(90));
+		this->m_.erase(this->m_.lower_bound(150), this->m_.end());
+		this->witness_.erase(this->witness_.lower_bound(150), this->witness_.end());
+		// Empty range is a no-op
+		this->m_.erase(this->m_.begin(), this->m_.begin());
+
+		EXPECT_EQ(this->m_.size(), this->witness_.size());
+		this->expectMatchesWitness(this->m_);
+
+		this->m_.erase(this->m_.begin(), this->m_.end());
+		EXPECT_TRUE(this->m_.empty());
+		EXPECT_TRUE(this->m_.begin() == this->m_.end());
+		this->m_.insert(ft::make_pair(1, 1));
+		EXPECT_EQ(this->m_.size(), size_t(1));
+	}
+
+	TYPED_TEST(MapTest, InsertWithHint)
+	{
+		// Exact hints: the element right after the new key, then the one
+		// right before it
+		for (int i = 1; i < lenm * 3; i += 3)
+		{
+			typename TypeParam::iterator	hint = this->m_.lower_bound(i);
+
+			EXPECT_EQ(this->m_.insert(hint, ft::make_pair(i, -i))->first, i);
+			this->witness_.insert(std::make_pair(i, -i));
+		}
+		for (int i = 2; i < lenm * 3 / 2; i += 3)
+		{
+			typename TypeParam::iterator	hint = this->m_.find(i - 1);
+
+			EXPECT_EQ(this->m_.insert(hint, ft::make_pair(i, i))->first, i);
+			this->witness_.insert(std::make_pair(i, i));
+		}
+		// Hints far off, and a far hint on a key that is already there
+		for (int i = lenm * 3 / 2 + 2; i < lenm * 3; i += 3)
+		{
+			EXPECT_EQ(this->m_.insert(this->m_.begin(), ft::make_pair(i, i))->first, i);
+			EXPECT_EQ(this->m_.insert(this->m_.end(), ft::make_pair(i, 0))->second, i);
+			this->witness_.insert(std::make_pair(i, i));
+		}
+		EXPECT_EQ(this->m_.insert(this->m_.find(7), ft::make_pair(6, 42))->second, 2);
+
+		EXPECT_EQ(this->m_.size(), this->witness_.size());
+		this->expectMatchesWitness(this->m_);
+	}
+
+	TYPED_TEST(MapTest, IteratorsSurviveRebalancing)
+	{
+		typename TypeParam::iterator	held = this->m_.find(90);
+
+		// Enough inserts and erases around the held node to rotate it
+		for (int i = 0; i < lenm * 3; i += 3)
+		{
+			if (i == 90)
+				continue ;
+			this->m_.insert(ft::make_pair(i + 1, i));
+			this->witness_.insert(std::make_pair(i + 1, i));
+			this->m_.erase(i);
+			this->witness_.erase(i);
+		}
+
+		std::map< int, int >::iterator	sheld = this->witness_.find(90);
+		typename TypeParam::iterator	next = held;
+		std::map< int, int >::iterator	snext = sheld;
+		EXPECT_TRUE(comp_pair(*++next, *++snext));
+		next = held;
+		snext = sheld;
+		EXPECT_TRUE(comp_pair(*--next, *--snext));
+
+		// Partial scan, both ways
+		typename TypeParam::iterator	it = this->m_.lower_bound(50);
+		typename TypeParam::iterator	last = this->m_.upper_bound(130);
+		std::map< int, int >::iterator	sit = this->witness_.lower_bound(50);
+		for (; it != last; ++it, ++sit)
+			EXPECT_TRUE(comp_pair(*it, *sit));
+		EXPECT_TRUE(sit == this->witness_.upper_bound(130));
+		while (it != this->m_.lower_bound(50))
+			EXPECT_TRUE(comp_pair(*--it, *--sit));
+	}
 }  // namespace
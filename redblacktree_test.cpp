@@ -8,6 +8,27 @@
 
 namespace {
 
+	// Leaves are the tree's sentinel: it is the only node without children
+	template < class T >
+	bool isLeaf(T node)
+	{
+		return (!node->left && !node->right);
+	}
+
+	// Compares data, colours and parent links, node by node
+	template < class T >
+	bool sameShape(T a, T b)
+	{
+		if (isLeaf(a) || isLeaf(b))
+			return (isLeaf(a) == isLeaf(b));
+		if (a == b || a->data != b->data || a->color != b->color)
+			return (false);
+		if ((!isLeaf(a->left) && a->left->parent != a) || (!isLeaf(a->right) && a->right->parent != a)
+			|| (!isLeaf(b->left) && b->left->parent != b) || (!isLeaf(b->right) && b->right->parent != b))
+			return (false);
+		return (sameShape(a->left, b->left) && sameShape(a->right, b->right));
+	}
+
 	TEST(TestRBTree, IsExisting) {
 		ft::RedBlackTree< int >	rbtree;
 
@@ -102,6 +123,26 @@ namespace {
 		EXPECT_TRUE(rbtree.checker(rbtree.getRoot()));
 	}
 
+	TEST(TestRBTree, TransferBetweenTreesValid)
+	{
+		ft::RedBlackTree< int >	active;
+		ft::RedBlackTree< int >	expiring;
+
+		for (int i = 0; i < 200; i++)
+				active.insert(i);
+
+		// Move the oldest keys, then every third key, from one tree to the other
+		for (int i = 0; i < 200; i++)
+		{
+			if (i >= 40 && i % 3)
+				continue ;
+			active.deleteNode(i);
+			expiring.insert(i);
+			EXPECT_TRUE(active.checker(active.getRoot())) << "key " << i;
+			EXPECT_TRUE(expiring.checker(expiring.getRoot())) << "key " << i;
+		}
+	}
+
 	TEST(TestRBTree, CopyConstructor) {
 		ft::RedBlackTree< int >	rbtree;
 
@@ -130,4 +171,123 @@ namespace {
 		EXPECT_TRUE(rbtree.checker(rbtree2.getRoot()));
 		EXPECT_TRUE(rbtree2 == rbtree);
 	}
+
+	// Today's copy re-inserts every element, so the shapes differ;
+	// enable once RedBlackTree copies by cloning
+	TEST(TestRBTree, DISABLED_CopyPreservesShape) {
+		ft::RedBlackTree< int >	rbtree;
+
+		for (int i = 0; i < 300; i++)
+				rbtree.insert((i * 37) % 300);
+		for (int i = 0; i < 300; i += 7)
+				rbtree.deleteNode(i);
+
+		ft::RedBlackTree< int >	rbtree2(rbtree);
+		ft::RedBlackTree< int >	rbtree3;
+		for (int i = 0; i < 10; i++)
+				rbtree3.insert(i);
+		rbtree3 = rbtree;
+
+		// Copies must clone nodes, links and colours, not rebuild them
+		EXPECT_TRUE(rbtree2.checker(rbtree2.getRoot()));
+		EXPECT_TRUE(rbtree3.checker(rbtree3.getRoot()));
+		EXPECT_TRUE(sameShape(rbtree.getRoot(), rbtree2.getRoot()));
+		EXPECT_TRUE(sameShape(rbtree.getRoot(), rbtree3.getRoot()));
+	}
+
+	TEST(TestRBTree, LargeCopyAndDestruction) {
+		ft::RedBlackTree< int >	*rbtree = new ft::RedBlackTree< int >;
+
+		for (int i = 0; i < 100000; i++)
+				rbtree->insert(i);
+
+		ft::RedBlackTree< int >	rbtree2(*rbtree);
+		EXPECT_TRUE(rbtree2 == *rbtree);
+		delete rbtree;
+		EXPECT_TRUE(rbtree2.checker(rbtree2.getRoot()));
+	}
+
+	// A recursive copy or destroy overflows the stack on a chain this
+	// long; enable once RedBlackTree copies and tears down iteratively
+	TEST(TestRBTree, DISABLED_DeepCopyAndDestruction) {
+		ft::RedBlackTree< int >	*rbtree = new ft::RedBlackTree< int >;
+		const int				n = 1000000;
+
+		for (int i = 0; i < n; i++)
+				rbtree->insert(i);
+
+		// Rotate every left child up until the tree is a right-leaning chain
+		ft::RedBlackTree< int >::node_pointer	node(rbtree->getRoot());
+		while (!isLeaf(node))
+		{
+			if (!isLeaf(node->left))
+			{
+				rbtree->rightRotate(node);
+				node = node->parent;
+			}
+			else
+				node = node->right;
+		}
+
+		int	depth = 0;
+		for (node = rbtree->getRoot(); !isLeaf(node); node = node->right)
+			depth++;
+		EXPECT_EQ(depth, n);
+
+		ft::RedBlackTree< int >	rbtree2(*rbtree);
+		delete rbtree;
+	}
+
+	TEST(TestRBTree, AdversarialSequencesValid) {
+		// Fixed seed so that a failing sequence can be replayed
+		unsigned int	seed = 42;
+		const int		n = 2000;
+
+		for (int pattern = 0; pattern < 4; pattern++)
+		{
+			ft::RedBlackTree< int >	rbtree;
+			bool					present[n] = { false };
+
+			for (int i = 0; i < n; i++)
+			{
+				int	key;
+
+				if (pattern == 0)
+					key = i;
+				else if (pattern == 1)
+					key = n - 1 - i;
+				else if (pattern == 2)
+					key = (i % 2) ? n - 1 - i : i;
+				else
+				{
+					seed = seed * 1103515245 + 12345;
+					key = (seed >> 16) % n;
+				}
+				if (!present[key])
+				{
+					rbtree.insert(key);
+					present[key] = true;
+				}
+				// Delete an unrelated key, drawn separately, so that removals
+				// hit black inner nodes and not only the leaf just inserted
+				if (pattern == 3 && i % 3 == 0)
+				{
+					seed = seed * 1103515245 + 12345;
+					int	victim = (seed >> 16) % n;
+					for (int j = 0; j < n && !present[victim]; j++)
+						victim = (victim + 1) % n;
+					if (present[victim])
+					{
+						rbtree.deleteNode(victim);
+						present[victim] = false;
+					}
+				}
+				if (i % 100 == 0)
+				{
+					EXPECT_TRUE(rbtree.checker(rbtree.getRoot())) << "pattern " << pattern << " step " << i;
+				}
+			}
+			EXPECT_TRUE(rbtree.checker(rbtree.getRoot())) << "pattern " << pattern;
+		}
+	}
 }  // namespace